@@ -1,5 +1,6 @@
 #include "CSetReplace.h"
 #include "Set.hpp"
+#include "InitialConditionFile.hpp"
 #include <cstdio>
 
 const CEventID kCEventIDInitialCondition = SetReplace::initialConditionEvent;
@@ -283,6 +284,15 @@ const CSetError kCSetErrorAborted = (+Set::Error::Aborted);
 const CSetError kCSetErrorDisconnectedInputs = (+Set::Error::DisconnectedInputs);
 const CSetError kCSetErrorNonPositiveAtoms = (+Set::Error::NonPositiveAtoms);
 const CSetError kCSetErrorAtomCountOverflow = (+Set::Error::AtomCountOverflow);
+// File errors are raised by this layer rather than by Set, so they count down from the top
+// of the range; UInt64.max itself is taken by SetReplaceError.locked on the Swift side.
+const CSetError kCSetErrorFileUnreadable = UINT64_MAX - 1;
+const CSetError kCSetErrorFileMalformed = UINT64_MAX - 2;
+const CSetError kCSetErrorUnknownFileFormat = UINT64_MAX - 3;
+
+const CInitialConditionFormat kCInitialConditionFormatAutomatic = (+InitialConditionFile::Format::Automatic);
+const CInitialConditionFormat kCInitialConditionFormatBinary = (+InitialConditionFile::Format::Binary);
+const CInitialConditionFormat kCInitialConditionFormatText = (+InitialConditionFile::Format::Text);
 
 
 CSet *_Nullable CSet_Create(CRulesVectorRef rules, CAtomsVectorVectorRef initialExpressions, COrderingSpecRef orderingSpec, unsigned int randomSeed, CHandleErrorBlock handleError) {
@@ -301,6 +311,39 @@ CSet *_Nullable CSet_Create(CRulesVectorRef rules, CAtomsVectorVectorRef initial
     }
 }
 
+CSet *_Nullable CSet_CreateFromFile(CRulesVectorRef rules, const char *path, CInitialConditionFormat format, unsigned int parseThreads, COrderingSpecRef orderingSpec, unsigned int randomSeed, CHandleErrorBlock handleError) {
+    
+    const std::vector<Rule> &_rules = *(std::vector<Rule> *)rules;
+    const Matcher::OrderingSpec &_orderingSpec = *(Matcher::OrderingSpec *)orderingSpec;
+    
+    if (format > kCInitialConditionFormatText) {
+        handleError(kCSetErrorUnknownFileFormat);
+        return nullptr;
+    }
+    
+    std::vector<AtomsVector> initialExpressions;
+    auto fileError = InitialConditionFile::read(path, static_cast<InitialConditionFile::Format>(format), parseThreads, initialExpressions);
+    switch (fileError) {
+        case InitialConditionFile::Error::None:
+            break;
+        case InitialConditionFile::Error::Unreadable:
+            handleError(kCSetErrorFileUnreadable);
+            return nullptr;
+        case InitialConditionFile::Error::Malformed:
+            handleError(kCSetErrorFileMalformed);
+            return nullptr;
+    }
+    
+    try {
+        Set *set = new Set(_rules, initialExpressions, _orderingSpec, randomSeed);
+        return (CSet *)set;
+    } catch(Set::Error error) {
+        CSetError cError = (+error);
+        handleError(cError);
+        return nullptr;
+    }
+}
+
 void CSet_Destroy(CSetRef set) {
     Set *_set = (Set *)set;
     delete _set;
@@ -0,0 +1,254 @@
+#include "InitialConditionFile.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SetReplace {
+
+namespace {
+
+// The binary format is little-endian and read in place, without byte swapping.
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "Binary initial condition files can only be read on little-endian hosts.");
+
+const char binaryMagic[4] = {'W', 'M', 'I', 'C'};
+const uint32_t binaryVersion = 1;
+
+struct BinaryHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t expressionCount;
+    uint64_t atomCount;
+};
+
+/// Text chunks smaller than this are not worth a thread of their own.
+const size_t minimumChunkSize = 1 << 20;
+
+/// A read-only memory mapping of a whole file, unmapped on destruction.
+class MappedFile {
+public:
+    explicit MappedFile(const char *path) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+            close(fd);
+            return;
+        }
+
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                close(fd);
+                return;
+            }
+            data_ = static_cast<const char *>(data);
+        }
+        close(fd);
+        isValid_ = true;
+    }
+
+    ~MappedFile() {
+        if (data_ != nullptr) munmap(const_cast<char *>(data_), size_);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// Passes an access pattern hint such as `MADV_SEQUENTIAL` on to the kernel.
+    void advise(int advice) const {
+        if (data_ != nullptr) madvise(const_cast<char *>(data_), size_, advice);
+    }
+
+    bool isValid() const { return isValid_; }
+    const char *data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    bool isValid_ = false;
+};
+
+bool hasBinaryMagic(const MappedFile &file) {
+    return file.size() >= sizeof(binaryMagic) && memcmp(file.data(), binaryMagic, sizeof(binaryMagic)) == 0;
+}
+
+InitialConditionFile::Error readBinary(const MappedFile &file, std::vector<AtomsVector> &expressions) {
+    BinaryHeader header;
+    if (file.size() < sizeof(header)) return InitialConditionFile::Error::Malformed;
+    memcpy(&header, file.data(), sizeof(header));
+    file.advise(MADV_SEQUENTIAL);
+
+    if (memcmp(header.magic, binaryMagic, sizeof(binaryMagic)) != 0 || header.version != binaryVersion) {
+        return InitialConditionFile::Error::Malformed;
+    }
+
+    const uint64_t wordCount = (file.size() - sizeof(header)) / sizeof(uint64_t);
+    if ((file.size() - sizeof(header)) % sizeof(uint64_t) != 0 ||
+        header.expressionCount > wordCount ||
+        header.atomCount != wordCount - header.expressionCount) {
+        return InitialConditionFile::Error::Malformed;
+    }
+
+    // The header is 24 bytes and the mapping is page-aligned, so both arrays are 8-byte aligned.
+    const uint64_t *lengths = reinterpret_cast<const uint64_t *>(file.data() + sizeof(header));
+    const Atom *atoms = reinterpret_cast<const Atom *>(lengths + header.expressionCount);
+
+    expressions.reserve(header.expressionCount);
+    uint64_t offset = 0;
+    for (uint64_t i = 0; i < header.expressionCount; i++) {
+        const uint64_t length = lengths[i];
+        if (length > header.atomCount - offset) {
+            return InitialConditionFile::Error::Malformed;
+        }
+        expressions.emplace_back(atoms + offset, atoms + offset + length);
+        offset += length;
+    }
+
+    if (offset != header.atomCount) {
+        return InitialConditionFile::Error::Malformed;
+    }
+    return InitialConditionFile::Error::None;
+}
+
+inline bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == ',';
+}
+
+/// Parses the lines in `[begin, end)`, appending one expression per non-empty line.
+bool parseTextChunk(const char *begin, const char *end, std::vector<AtomsVector> &expressions) {
+    const char *p = begin;
+    while (p < end) {
+        while (p < end && isSeparator(*p)) p++;
+        if (p < end && *p == '#') {
+            while (p < end && *p != '\n') p++;
+        }
+
+        AtomsVector atoms;
+        while (p < end && *p != '\n') {
+            const bool isNegative = (*p == '-');
+            if (*p == '-' || *p == '+') p++;
+            if (p == end || *p < '0' || *p > '9') return false;
+
+            uint64_t magnitude = 0;
+            const uint64_t limit = isNegative
+                ? static_cast<uint64_t>(std::numeric_limits<Atom>::max()) + 1
+                : static_cast<uint64_t>(std::numeric_limits<Atom>::max());
+            while (p < end && *p >= '0' && *p <= '9') {
+                const uint64_t digit = static_cast<uint64_t>(*p - '0');
+                if (magnitude > (limit - digit) / 10) return false;
+                magnitude = magnitude * 10 + digit;
+                p++;
+            }
+            if (p < end && *p != '\n' && !isSeparator(*p)) return false;
+
+            atoms.push_back(isNegative ? static_cast<Atom>(0 - magnitude) : static_cast<Atom>(magnitude));
+            while (p < end && isSeparator(*p)) p++;
+        }
+        if (p < end) p++;
+
+        if (!atoms.empty()) expressions.push_back(std::move(atoms));
+    }
+    return true;
+}
+
+InitialConditionFile::Error readText(const MappedFile &file,
+                                     unsigned int parseThreads,
+                                     std::vector<AtomsVector> &expressions) {
+    const char *begin = file.data();
+    const char *end = begin + file.size();
+
+    unsigned int threadCount = parseThreads > 0 ? parseThreads : std::thread::hardware_concurrency();
+    threadCount = static_cast<unsigned int>(std::min<size_t>(std::max(threadCount, 1u),
+                                                             std::max<size_t>(file.size() / minimumChunkSize, 1)));
+
+    if (threadCount == 1) {
+        file.advise(MADV_SEQUENTIAL);
+        return parseTextChunk(begin, end, expressions)
+            ? InitialConditionFile::Error::None
+            : InitialConditionFile::Error::Malformed;
+    }
+
+    // Chunks are read concurrently from different offsets, so sequential readahead would not help.
+    file.advise(MADV_WILLNEED);
+
+    // Split on line boundaries so that every line belongs to exactly one chunk.
+    std::vector<const char *> boundaries{begin};
+    for (unsigned int i = 1; i < threadCount; i++) {
+        const char *boundary = std::max(begin + file.size() / threadCount * i, boundaries.back());
+        boundary = std::find(boundary, end, '\n');
+        boundaries.push_back(boundary == end ? end : boundary + 1);
+    }
+    boundaries.push_back(end);
+
+    std::vector<std::vector<AtomsVector>> chunks(threadCount);
+    std::unique_ptr<bool[]> succeeded(new bool[threadCount]);
+    auto parseChunk = [&](unsigned int i) {
+        succeeded[i] = parseTextChunk(boundaries[i], boundaries[i + 1], chunks[i]);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    unsigned int startedCount = 0;
+    try {
+        for (; startedCount < threadCount; startedCount++) {
+            threads.emplace_back(parseChunk, startedCount);
+        }
+    } catch (const std::system_error &) {
+        // Out of threads, so the calling thread parses the chunks that did not get one.
+    }
+    for (unsigned int i = startedCount; i < threadCount; i++) parseChunk(i);
+    for (auto &thread : threads) thread.join();
+
+    size_t totalCount = 0;
+    for (unsigned int i = 0; i < threadCount; i++) {
+        if (!succeeded[i]) return InitialConditionFile::Error::Malformed;
+        totalCount += chunks[i].size();
+    }
+
+    // Moving the per-chunk vectors hands over their atom buffers without copying them.
+    expressions.reserve(totalCount);
+    for (auto &chunk : chunks) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(expressions));
+        std::vector<AtomsVector>().swap(chunk);
+    }
+    return InitialConditionFile::Error::None;
+}
+
+}
+
+InitialConditionFile::Error InitialConditionFile::read(const char *path,
+                                                       Format format,
+                                                       unsigned int parseThreads,
+                                                       std::vector<AtomsVector> &expressions) {
+    expressions.clear();
+
+    MappedFile file(path);
+    if (!file.isValid()) return Error::Unreadable;
+
+    if (format == Format::Automatic) {
+        format = hasBinaryMagic(file) ? Format::Binary : Format::Text;
+    }
+
+    const Error error = (format == Format::Binary)
+        ? readBinary(file, expressions)
+        : readText(file, parseThreads, expressions);
+    if (error != Error::None) expressions.clear();
+    return error;
+}
+
+}
@@ -0,0 +1,38 @@
+#ifndef InitialConditionFile_hpp
+#define InitialConditionFile_hpp
+
+#include "Expression.hpp"
+#include <vector>
+
+namespace SetReplace {
+
+/// Streaming reader for initial conditions stored on disk.
+///
+/// The file is memory-mapped and parsed straight into `expressions`, so the only
+/// heap copy of the data is the one handed to `Set`.
+///
+/// Two formats are understood:
+///
+/// - Binary: the 4-byte magic `WMIC`, a `uint32_t` version (currently 1), a `uint64_t`
+///   expression count `E`, a `uint64_t` atom count `A`, then `E` `uint64_t` expression
+///   lengths, followed by `A` `int64_t` atoms. All fields are little-endian.
+/// - Text: one expression per line, atoms separated by whitespace and/or commas.
+///   Blank lines and lines starting with `#` are ignored.
+class InitialConditionFile {
+public:
+    enum class Format { Automatic, Binary, Text };
+
+    enum class Error { None, Unreadable, Malformed };
+
+    /// Reads the file at `path` into `expressions`, replacing its contents.
+    /// Text files are split into up to `parseThreads` chunks parsed concurrently,
+    /// with 0 meaning one per hardware thread. The resulting order matches the file.
+    static Error read(const char *path,
+                      Format format,
+                      unsigned int parseThreads,
+                      std::vector<AtomsVector> &expressions);
+};
+
+}
+
+#endif /* InitialConditionFile_hpp */
@@ -245,6 +245,17 @@ extern const CSetError kCSetErrorAborted;
 extern const CSetError kCSetErrorDisconnectedInputs;
 extern const CSetError kCSetErrorNonPositiveAtoms;
 extern const CSetError kCSetErrorAtomCountOverflow;
+extern const CSetError kCSetErrorFileUnreadable;
+extern const CSetError kCSetErrorFileMalformed;
+extern const CSetError kCSetErrorUnknownFileFormat;
+
+
+// MARK: - Initial Condition File
+
+typedef uint64_t CInitialConditionFormat;
+extern const CInitialConditionFormat kCInitialConditionFormatAutomatic;
+extern const CInitialConditionFormat kCInitialConditionFormatBinary;
+extern const CInitialConditionFormat kCInitialConditionFormatText;
 
 
 // MARK: - Set
@@ -261,6 +272,15 @@ CSet_Create(CRulesVectorRef rules,
             unsigned int randomSeed,
             CHandleErrorBlock handleError);
 
+CSet *_Nullable
+CSet_CreateFromFile(CRulesVectorRef rules,
+                    const char *path,
+                    CInitialConditionFormat format,
+                    unsigned int parseThreads,
+                    COrderingSpecRef orderingSpec,
+                    unsigned int randomSeed,
+                    CHandleErrorBlock handleError);
+
 void
 CSet_Destroy(CSetRef set);
 
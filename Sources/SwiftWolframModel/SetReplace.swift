@@ -39,6 +39,44 @@ public final class SetReplace {
         self.set = _set
     }
     
+    /// Initializes a new environment with rules, initial expressions read from a file, and an update ordering spec.
+    /// The file is memory-mapped and parsed directly into the underlying set, without first building `[[Atom]]`.
+    /// Text files are parsed on up to `parseThreads` threads, where 0 uses one per core.
+    public init(
+        rules: [Rule],
+        initialConditionFile: URL,
+        format: InitialConditionFormat = .automatic,
+        parseThreads: Int = 0,
+        orderingSpec: [Ordering] = [],
+        randomSeed: UInt32 = 0
+    ) throws {
+        let ruleVec = rules.to_CRulesVector()
+        let cOrdering = orderingSpec.to_COrderingSpec()
+        
+        var errorCode: CSetError = 0
+        let set = initialConditionFile.withUnsafeFileSystemRepresentation { path -> OpaquePointer? in
+            guard let path = path else {
+                errorCode = kCSetErrorFileUnreadable
+                return nil
+            }
+            return CSet_CreateFromFile(
+                ruleVec,
+                path,
+                format.rawValue,
+                UInt32(clamping: max(parseThreads, 0)),
+                cOrdering,
+                randomSeed
+            ) { error in
+                errorCode = error
+            }
+        }
+        guard let _set = set else {
+            throw SetReplaceError(errorCode)
+        }
+        
+        self.set = _set
+    }
+    
     deinit { CSet_Destroy(self.set) }
     
     
@@ -329,6 +367,26 @@ public final class SetReplace {
     }
     
     
+    // MARK: - Initial Condition File Format
+    
+    /// The on-disk layout of an initial condition file.
+    ///
+    /// Binary files start with the magic `WMIC`, a `UInt32` version (1), a `UInt64` expression count
+    /// and a `UInt64` atom count, followed by one `UInt64` length per expression and then all atoms
+    /// as `Int64`, all little-endian. Text files hold one expression per line, with atoms separated
+    /// by whitespace or commas; blank lines and lines starting with `#` are skipped.
+    public struct InitialConditionFormat: RawRepresentable, Equatable {
+        public init(_ value: UInt64) { rawValue = value }
+        public init?(rawValue: UInt64) { self.init(rawValue) }
+        public let rawValue: UInt64
+        
+        /// Binary if the file starts with the binary magic, text otherwise.
+        public static let automatic = InitialConditionFormat(kCInitialConditionFormatAutomatic)
+        public static let binary = InitialConditionFormat(kCInitialConditionFormatBinary)
+        public static let text = InitialConditionFormat(kCInitialConditionFormatText)
+    }
+    
+    
     // MARK: - Errors
     
     /// Any of the errors that can be thrown during evaluation.
@@ -341,6 +399,9 @@ public final class SetReplace {
         public static let disconnectedInputs  = SetReplaceError(kCSetErrorDisconnectedInputs)
         public static let nonPositiveAtoms  = SetReplaceError(kCSetErrorNonPositiveAtoms)
         public static let atomCountOverflow = SetReplaceError(kCSetErrorAtomCountOverflow)
+        public static let fileUnreadable = SetReplaceError(kCSetErrorFileUnreadable)
+        public static let fileMalformed = SetReplaceError(kCSetErrorFileMalformed)
+        public static let unknownFileFormat = SetReplaceError(kCSetErrorUnknownFileFormat)
         public static let locked = SetReplaceError(UInt64.max)
         
         public var errorDescription: String? {
@@ -349,6 +410,9 @@ public final class SetReplace {
             case Self.disconnectedInputs: return "Disconnected inputs."
             case Self.nonPositiveAtoms: return "Non positive atoms."
             case Self.atomCountOverflow: return "Atom count overflow."
+            case Self.fileUnreadable: return "Initial condition file could not be read."
+            case Self.fileMalformed: return "Initial condition file is malformed."
+            case Self.unknownFileFormat: return "Unknown initial condition file format."
             case Self.locked: return "Set is busy."
             default: return nil
             }
@@ -17,4 +17,118 @@ final class SwiftWolframModelTests: XCTestCase {
         }
         
     }
+    
+    // MARK: Initial Condition Files
+    
+    private let fileRules = [Rule(inputs: [[-1, -2]], outputs: [[-1, -2], [-2, -3]])]
+    
+    private func temporaryFileURL() -> URL {
+        FileManager.default.temporaryDirectory
+            .appendingPathComponent("SwiftWolframModelTests-\(UUID().uuidString)")
+    }
+    
+    /// Encodes expressions in the binary initial condition format, optionally overriding the length table.
+    private func binaryInitialCondition(_ expressions: [[Atom]], lengths: [UInt64]? = nil) -> Data {
+        var data = Data("WMIC".utf8)
+        func append<T: FixedWidthInteger>(_ value: T) {
+            withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+        }
+        let atoms = expressions.flatMap { $0 }
+        append(UInt32(1))
+        append(UInt64(expressions.count))
+        append(UInt64(atoms.count))
+        (lengths ?? expressions.map { UInt64($0.count) }).forEach(append)
+        atoms.forEach { append($0.rawValue) }
+        return data
+    }
+    
+    private func assertLoads(
+        _ url: URL,
+        _ expected: [[Atom]],
+        format: SetReplace.InitialConditionFormat = .automatic,
+        parseThreads: Int = 0
+    ) throws {
+        let fromFile = try SetReplace(
+            rules: fileRules,
+            initialConditionFile: url,
+            format: format,
+            parseThreads: parseThreads,
+            randomSeed: 1
+        )
+        let fromArray = try SetReplace(
+            rules: fileRules,
+            initialExpressions: expected,
+            orderingSpec: [],
+            randomSeed: 1
+        )
+        XCTAssertEqual(fromFile.expressions.map { $0.atoms }, fromArray.expressions.map { $0.atoms })
+    }
+    
+    private func assertFails(
+        _ url: URL,
+        with expected: SetReplace.SetReplaceError,
+        format: SetReplace.InitialConditionFormat = .automatic
+    ) {
+        XCTAssertThrowsError(try SetReplace(rules: fileRules, initialConditionFile: url, format: format)) { error in
+            XCTAssertEqual(error as? SetReplace.SetReplaceError, expected)
+        }
+    }
+    
+    func testTextInitialConditionFile() throws {
+        let url = temporaryFileURL()
+        defer { try? FileManager.default.removeItem(at: url) }
+        
+        try "# initial condition\n1 2\n\n2, 3\n".write(to: url, atomically: true, encoding: .utf8)
+        try assertLoads(url, [[1, 2], [2, 3]])
+        try assertLoads(url, [[1, 2], [2, 3]], format: .text)
+        
+        try "1 two\n".write(to: url, atomically: true, encoding: .utf8)
+        assertFails(url, with: .fileMalformed)
+    }
+    
+    func testMultithreadedTextInitialConditionFile() throws {
+        let url = temporaryFileURL()
+        defer { try? FileManager.default.removeItem(at: url) }
+        
+        // Chunks are at least 1 MiB, so the file has to be several MiB to be split at all.
+        let expressions = (1_000_000..<1_200_000).map { [Atom($0), Atom($0 + 1)] }
+        let text = expressions.map { "\($0[0]) \($0[1])\n" }.joined()
+        XCTAssertGreaterThan(text.utf8.count, 3 << 20)
+        try text.write(to: url, atomically: true, encoding: .utf8)
+        
+        try assertLoads(url, expressions, parseThreads: 4)
+    }
+    
+    func testBinaryInitialConditionFile() throws {
+        let url = temporaryFileURL()
+        defer { try? FileManager.default.removeItem(at: url) }
+        let expressions: [[Atom]] = [[1, 2], [2, 3, 4], [4]]
+        let data = binaryInitialCondition(expressions)
+        
+        try data.write(to: url)
+        try assertLoads(url, expressions)
+        try assertLoads(url, expressions, format: .binary)
+        assertFails(url, with: .fileMalformed, format: .text)
+        
+        try data.dropLast(8).write(to: url)
+        assertFails(url, with: .fileMalformed)
+        
+        try data.prefix(12).write(to: url)
+        assertFails(url, with: .fileMalformed, format: .binary)
+        
+        try binaryInitialCondition(expressions, lengths: [2, 3, 2]).write(to: url)
+        assertFails(url, with: .fileMalformed)
+        
+        try binaryInitialCondition(expressions, lengths: [1, 3, 1]).write(to: url)
+        assertFails(url, with: .fileMalformed)
+    }
+    
+    func testInitialConditionFileErrors() throws {
+        let url = temporaryFileURL()
+        assertFails(url, with: .fileUnreadable)
+        
+        try "1 2\n".write(to: url, atomically: true, encoding: .utf8)
+        defer { try? FileManager.default.removeItem(at: url) }
+        assertFails(url, with: .unknownFileFormat, format: SetReplace.InitialConditionFormat(7))
+    }
 }